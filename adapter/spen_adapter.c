@@ -1,13 +1,51 @@
 #include "spen_adapter.h"
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
 #include <time.h>
+#include <errno.h>
 
 #ifdef __linux__
 #define _GNU_SOURCE
+#include <sys/eventfd.h>
 #endif
 
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <unistd.h>
+#define SPEN_HAVE_WAKE_FD 1
+#endif
+
+/* Flight recorder and wake-up helpers; lock-free on GCC/Clang, plain loads elsewhere */
+#if defined(__GNUC__) || defined(__clang__)
+#define SPEN_TRACE_CLAIM(p) __atomic_fetch_add((p), 1, __ATOMIC_RELAXED)
+#define SPEN_TRACE_PUBLISH(p, v) __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+#define SPEN_TRACE_LOAD(p) __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define SPEN_TRACE_STORE_RELAXED(p, v) __atomic_store_n((p), (v), __ATOMIC_RELAXED)
+#define SPEN_TRACE_LOAD_RELAXED(p) __atomic_load_n((p), __ATOMIC_RELAXED)
+#define SPEN_TRACE_FENCE_RELEASE() __atomic_thread_fence(__ATOMIC_RELEASE)
+#define SPEN_TRACE_FENCE_ACQUIRE() __atomic_thread_fence(__ATOMIC_ACQUIRE)
+#define SPEN_WAKE_LOAD(p) __atomic_load_n((p), __ATOMIC_SEQ_CST)
+#define SPEN_WAKE_BUMP(p) __atomic_add_fetch((p), 1, __ATOMIC_SEQ_CST)
+#define SPEN_WAKE_TEST_AND_SET(p) __atomic_exchange_n((p), true, __ATOMIC_SEQ_CST)
+#define SPEN_WAKE_CLEAR(p) __atomic_store_n((p), false, __ATOMIC_SEQ_CST)
+#else
+#define SPEN_TRACE_CLAIM(p) ((*(p))++)
+#define SPEN_TRACE_PUBLISH(p, v) (*(p) = (v))
+#define SPEN_TRACE_LOAD(p) (*(p))
+#define SPEN_TRACE_STORE_RELAXED(p, v) (*(p) = (v))
+#define SPEN_TRACE_LOAD_RELAXED(p) (*(p))
+#define SPEN_TRACE_FENCE_RELEASE() ((void)0)
+#define SPEN_TRACE_FENCE_ACQUIRE() ((void)0)
+#define SPEN_WAKE_LOAD(p) (*(p))
+#define SPEN_WAKE_BUMP(p) (++(*(p)))
+#define SPEN_WAKE_TEST_AND_SET(p) (*(p) ? true : !(*(p) = true))
+#define SPEN_WAKE_CLEAR(p) (*(p) = false)
+#endif
+
+#define SPEN_TRACE_MASK (SPEN_TRACE_CAPACITY - 1)
+
 /* Internal S-Pen context structure */
 struct spen_context {
     spen_state_t current_state;
@@ -32,6 +70,20 @@ struct spen_context {
     /* Coordinate transformation */
     spen_coordinate_transform_t transform_func;
     void* transform_user_data;
+    
+    /* Time source override */
+    spen_clock_t clock_func;
+    void* clock_user_data;
+    
+    /* Change notification */
+    uint32_t generation;
+    bool wake_pending;
+    int wake_read_fd;
+    int wake_write_fd;
+    
+    /* Flight recorder ring */
+    uint32_t trace_head;
+    spen_trace_record_t trace[SPEN_TRACE_CAPACITY];
 };
 
 /* Helper function to get current time in milliseconds */
@@ -41,6 +93,117 @@ static uint64_t spen_get_time_ms(void) {
     return (uint64_t)(ts.tv_sec * 1000 + ts.tv_nsec / 1000000);
 }
 
+/* Helper function to get the context's current time in milliseconds */
+static uint64_t spen_now(spen_context_t* ctx) {
+    if (ctx->clock_func) {
+        return ctx->clock_func(ctx->clock_user_data);
+    }
+    return spen_get_time_ms();
+}
+
+/* Helper function to saturate a coordinate into a trace record field */
+static int16_t spen_trace_clamp(float v) {
+    if (v > 32767.0f) return 32767;
+    if (v < -32768.0f) return -32768;
+    return (int16_t)v;
+}
+
+/*
+ * Append a record to the flight recorder, overwriting the oldest entry.
+ * Input events and core polls may arrive on different threads, so slots are
+ * claimed atomically.
+ */
+static void spen_trace(spen_context_t* ctx, uint64_t now, spen_trace_event_t event,
+                       unsigned arg0, unsigned arg1, float x, float y, int value) {
+    uint32_t index = SPEN_TRACE_CLAIM(&ctx->trace_head);
+    spen_trace_record_t* rec = &ctx->trace[index & SPEN_TRACE_MASK];
+    
+    /* Invalidate the slot; the fence keeps the payload stores behind it */
+    SPEN_TRACE_STORE_RELAXED(&rec->seq, (uint16_t)(index - 1));
+    SPEN_TRACE_FENCE_RELEASE();
+    SPEN_TRACE_STORE_RELAXED(&rec->timestamp_ms, (uint32_t)now);
+    SPEN_TRACE_STORE_RELAXED(&rec->event, (uint8_t)event);
+    SPEN_TRACE_STORE_RELAXED(&rec->arg0, (uint8_t)arg0);
+    SPEN_TRACE_STORE_RELAXED(&rec->arg1, (uint8_t)arg1);
+    SPEN_TRACE_STORE_RELAXED(&rec->reserved, (uint8_t)0);
+    SPEN_TRACE_STORE_RELAXED(&rec->x, spen_trace_clamp(x));
+    SPEN_TRACE_STORE_RELAXED(&rec->y, spen_trace_clamp(y));
+    SPEN_TRACE_STORE_RELAXED(&rec->value, spen_trace_clamp((float)value));
+    SPEN_TRACE_PUBLISH(&rec->seq, (uint16_t)index);
+}
+
+/* Copy a record if it still holds sequence number seq; false if torn or lapped */
+static bool spen_trace_read(const spen_trace_record_t* rec, uint16_t seq,
+                            spen_trace_record_t* out) {
+    if (SPEN_TRACE_LOAD(&rec->seq) != seq) return false;
+    
+    out->timestamp_ms = SPEN_TRACE_LOAD_RELAXED(&rec->timestamp_ms);
+    out->event = SPEN_TRACE_LOAD_RELAXED(&rec->event);
+    out->arg0 = SPEN_TRACE_LOAD_RELAXED(&rec->arg0);
+    out->arg1 = SPEN_TRACE_LOAD_RELAXED(&rec->arg1);
+    out->reserved = SPEN_TRACE_LOAD_RELAXED(&rec->reserved);
+    out->x = SPEN_TRACE_LOAD_RELAXED(&rec->x);
+    out->y = SPEN_TRACE_LOAD_RELAXED(&rec->y);
+    out->value = SPEN_TRACE_LOAD_RELAXED(&rec->value);
+    out->seq = seq;
+    
+    /* Keep the payload loads ahead of the re-check */
+    SPEN_TRACE_FENCE_ACQUIRE();
+    return SPEN_TRACE_LOAD_RELAXED(&rec->seq) == seq;
+}
+
+/* Helper function to make the wake descriptor readable */
+static void spen_signal_wake_fd(spen_context_t* ctx) {
+#ifdef SPEN_HAVE_WAKE_FD
+    if (ctx->wake_write_fd >= 0) {
+        uint64_t one = 1;
+        ssize_t written;
+        do {
+#ifdef __linux__
+            written = write(ctx->wake_write_fd, &one, sizeof(one));
+#else
+            written = write(ctx->wake_write_fd, &one, 1);
+#endif
+        } while (written < 0 && errno == EINTR);
+    }
+#else
+    (void)ctx;
+#endif
+}
+
+/* Record a state change and wake the frontend once per burst */
+static void spen_notify_change(spen_context_t* ctx) {
+    SPEN_WAKE_BUMP(&ctx->generation);
+    
+    if (SPEN_WAKE_TEST_AND_SET(&ctx->wake_pending)) {
+        return; /* Frontend has not consumed the previous wake-up yet */
+    }
+    spen_signal_wake_fd(ctx);
+}
+
+/* Helper function to create the wake descriptor; leaves -1 on failure */
+static void spen_open_wake_fd(spen_context_t* ctx) {
+#ifdef SPEN_HAVE_WAKE_FD
+#ifdef __linux__
+    int fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (fd < 0) return;
+    ctx->wake_read_fd = fd;
+    ctx->wake_write_fd = fd;
+#else
+    int fds[2];
+    if (pipe(fds) != 0) return;
+    for (int i = 0; i < 2; i++) {
+        fcntl(fds[i], F_SETFL, fcntl(fds[i], F_GETFL) | O_NONBLOCK);
+        fcntl(fds[i], F_SETFD, FD_CLOEXEC);
+    }
+    ctx->wake_read_fd = fds[0];
+    ctx->wake_write_fd = fds[1];
+#endif
+#else
+    (void)ctx;
+#endif
+}
+
 /* Helper function to calculate distance between two points */
 static float spen_distance(float x1, float y1, float x2, float y2) {
     float dx = x2 - x1;
@@ -59,6 +222,11 @@ spen_context_t* spen_init(void) {
     ctx->hover_guard_time_ms = 100;
     ctx->hover_guard_radius_px = 12.0f;
     
+    /* Wake descriptor is created up front so it never changes under a writer */
+    ctx->wake_read_fd = -1;
+    ctx->wake_write_fd = -1;
+    spen_open_wake_fd(ctx);
+    
     /* Initialize input mapping defaults */
     ctx->tap_action = SPEN_ACTION_LEFT_CLICK;
     ctx->barrel_action = SPEN_ACTION_RIGHT_CLICK;
@@ -74,6 +242,12 @@ spen_context_t* spen_init(void) {
 
 void spen_cleanup(spen_context_t* ctx) {
     if (ctx) {
+#ifdef SPEN_HAVE_WAKE_FD
+        if (ctx->wake_read_fd >= 0) close(ctx->wake_read_fd);
+        if (ctx->wake_write_fd >= 0 && ctx->wake_write_fd != ctx->wake_read_fd) {
+            close(ctx->wake_write_fd);
+        }
+#endif
         free(ctx);
     }
 }
@@ -81,7 +255,10 @@ void spen_cleanup(spen_context_t* ctx) {
 void spen_on_hover(spen_context_t* ctx, float x, float y, float pressure) {
     if (!ctx) return;
     
-    uint64_t now = spen_get_time_ms();
+    uint64_t now = spen_now(ctx);
+    const spen_state_t* last = &ctx->current_state;
+    bool changed = !last->hover || last->contact || last->x != x || last->y != y ||
+                   last->pressure != pressure;
     
     /* Update state */
     ctx->previous_state = ctx->current_state;
@@ -91,18 +268,27 @@ void spen_on_hover(spen_context_t* ctx, float x, float y, float pressure) {
     ctx->current_state.contact = false;
     ctx->current_state.hover = true;
     ctx->current_state.timestamp = now;
+    spen_trace(ctx, now, SPEN_TRACE_HOVER, 0, 0, x, y, (int)(pressure * 1000.0f));
     
     /* Arm hover guard */
+    if (!ctx->hover_guard_active) {
+        spen_trace(ctx, now, SPEN_TRACE_GUARD_ARM, 0, 0, x, y, ctx->hover_guard_time_ms);
+    }
     ctx->hover_guard_active = true;
     ctx->hover_guard_until = now + ctx->hover_guard_time_ms;
     ctx->hover_guard_x = x;
     ctx->hover_guard_y = y;
+    
+    if (changed) spen_notify_change(ctx);
 }
 
 void spen_on_contact(spen_context_t* ctx, float x, float y, float pressure) {
     if (!ctx) return;
     
-    uint64_t now = spen_get_time_ms();
+    uint64_t now = spen_now(ctx);
+    const spen_state_t* last = &ctx->current_state;
+    bool changed = !last->contact || last->x != x || last->y != y ||
+                   last->pressure != pressure;
     
     /* Update state */
     ctx->previous_state = ctx->current_state;
@@ -112,28 +298,45 @@ void spen_on_contact(spen_context_t* ctx, float x, float y, float pressure) {
     ctx->current_state.contact = true;
     ctx->current_state.hover = false;
     ctx->current_state.timestamp = now;
+    spen_trace(ctx, now, SPEN_TRACE_CONTACT, 0, 0, x, y, (int)(pressure * 1000.0f));
     
     /* Disable hover guard on actual contact */
-    ctx->hover_guard_active = false;
+    if (ctx->hover_guard_active) {
+        ctx->hover_guard_active = false;
+        spen_trace(ctx, now, SPEN_TRACE_GUARD_DISARM, 0, 0, x, y, 0);
+    }
+    
+    if (changed) spen_notify_change(ctx);
 }
 
 void spen_on_button(spen_context_t* ctx, spen_button_t button, bool pressed) {
     if (!ctx || button < 0 || button >= 32) return;
     
+    uint32_t last_buttons = ctx->current_state.button_state;
     if (pressed) {
         ctx->current_state.button_state |= (1U << button);
     } else {
         ctx->current_state.button_state &= ~(1U << button);
     }
     
-    ctx->current_state.timestamp = spen_get_time_ms();
+    ctx->current_state.timestamp = spen_now(ctx);
+    spen_trace(ctx, ctx->current_state.timestamp, SPEN_TRACE_BUTTON,
+               (unsigned)button, pressed ? 1 : 0,
+               ctx->current_state.x, ctx->current_state.y, 0);
+    
+    if (ctx->current_state.button_state != last_buttons) spen_notify_change(ctx);
 }
 
 void spen_on_tool_type(spen_context_t* ctx, spen_tool_type_t tool_type) {
     if (!ctx) return;
     
+    bool changed = ctx->current_state.tool_type != tool_type;
     ctx->current_state.tool_type = tool_type;
-    ctx->current_state.timestamp = spen_get_time_ms();
+    ctx->current_state.timestamp = spen_now(ctx);
+    spen_trace(ctx, ctx->current_state.timestamp, SPEN_TRACE_TOOL_TYPE,
+               (unsigned)tool_type, 0, ctx->current_state.x, ctx->current_state.y, 0);
+    
+    if (changed) spen_notify_change(ctx);
 }
 
 const spen_state_t* spen_get_state(spen_context_t* ctx) {
@@ -151,12 +354,19 @@ bool spen_require_contact(spen_context_t* ctx) {
     return ctx->require_contact_for_click;
 }
 
-int16_t spen_emit_libretro_pointer(spen_context_t* ctx, 
-                                   retro_input_state_t input_state_cb,
-                                   unsigned port, unsigned device,
-                                   unsigned index, unsigned id) {
-    if (!ctx) return 0;
-    
+/* Helper function to run the core transform and record its output */
+static void spen_apply_transform(spen_context_t* ctx, uint64_t now, const spen_state_t* state,
+                                 int* out_x, int* out_y) {
+    ctx->transform_func(state->x, state->y, out_x, out_y, ctx->transform_user_data);
+    spen_trace(ctx, now, SPEN_TRACE_TRANSFORM, 0, 0,
+               (float)*out_x, (float)*out_y, 0);
+}
+
+/* Resolve a libretro input query against the current S-Pen state */
+static int16_t spen_resolve_pointer(spen_context_t* ctx, uint64_t now,
+                                    retro_input_state_t input_state_cb,
+                                    unsigned port, unsigned device,
+                                    unsigned index, unsigned id) {
     const spen_state_t* state = &ctx->current_state;
     
     /* Handle libretro pointer device queries */
@@ -165,8 +375,7 @@ int16_t spen_emit_libretro_pointer(spen_context_t* ctx,
             case 0: /* RETRO_DEVICE_ID_POINTER_X */
                 if (ctx->transform_func && (state->contact || state->hover)) {
                     int transformed_x, transformed_y;
-                    ctx->transform_func(state->x, state->y, &transformed_x, &transformed_y,
-                                        ctx->transform_user_data);
+                    spen_apply_transform(ctx, now, state, &transformed_x, &transformed_y);
                     return (int16_t)transformed_x;
                 }
                 return (int16_t)state->x;
@@ -174,8 +383,7 @@ int16_t spen_emit_libretro_pointer(spen_context_t* ctx,
             case 1: /* RETRO_DEVICE_ID_POINTER_Y */
                 if (ctx->transform_func && (state->contact || state->hover)) {
                     int transformed_x, transformed_y;
-                    ctx->transform_func(state->x, state->y, &transformed_x, &transformed_y,
-                                        ctx->transform_user_data);
+                    spen_apply_transform(ctx, now, state, &transformed_x, &transformed_y);
                     return (int16_t)transformed_y;
                 }
                 return (int16_t)state->y;
@@ -199,18 +407,20 @@ int16_t spen_emit_libretro_pointer(spen_context_t* ctx,
     
     /* Check hover guard for phantom touch suppression */
     if (ctx->hover_guard_active) {
-        uint64_t now = spen_get_time_ms();
         if (now < ctx->hover_guard_until) {
             /* Check if this might be a phantom touch near the hover location */
             float distance = spen_distance(state->x, state->y, 
                                            ctx->hover_guard_x, ctx->hover_guard_y);
             if (distance <= ctx->hover_guard_radius_px) {
                 /* Suppress phantom touch */
+                spen_trace(ctx, now, SPEN_TRACE_GUARD_SUPPRESS, device, id,
+                           state->x, state->y, (int)distance);
                 return 0;
             }
         } else {
             /* Hover guard expired */
             ctx->hover_guard_active = false;
+            spen_trace(ctx, now, SPEN_TRACE_GUARD_EXPIRE, 0, 0, state->x, state->y, 0);
         }
     }
     
@@ -218,6 +428,20 @@ int16_t spen_emit_libretro_pointer(spen_context_t* ctx,
     return input_state_cb ? input_state_cb(port, device, index, id) : 0;
 }
 
+int16_t spen_emit_libretro_pointer(spen_context_t* ctx, 
+                                   retro_input_state_t input_state_cb,
+                                   unsigned port, unsigned device,
+                                   unsigned index, unsigned id) {
+    if (!ctx) return 0;
+    
+    /* One clock read per query, shared by every record it produces */
+    uint64_t now = spen_now(ctx);
+    int16_t result = spen_resolve_pointer(ctx, now, input_state_cb, port, device, index, id);
+    spen_trace(ctx, now, SPEN_TRACE_POLL, device, id,
+               ctx->current_state.x, ctx->current_state.y, result);
+    return result;
+}
+
 void spen_set_coordinate_transform(spen_context_t* ctx, 
                                    spen_coordinate_transform_t transform_func,
                                    void* user_data) {
@@ -227,6 +451,13 @@ void spen_set_coordinate_transform(spen_context_t* ctx,
     ctx->transform_user_data = user_data;
 }
 
+void spen_set_clock(spen_context_t* ctx, spen_clock_t clock_func, void* user_data) {
+    if (!ctx) return;
+    
+    ctx->clock_func = clock_func;
+    ctx->clock_user_data = user_data;
+}
+
 void spen_configure_hover_guard(spen_context_t* ctx, 
                                 int guard_time_ms, float guard_radius_px) {
     if (!ctx) return;
@@ -277,9 +508,8 @@ static bool spen_action_triggered(spen_context_t* ctx, spen_action_t action) {
     }
 }
 
-bool spen_get_mapped_button(spen_context_t* ctx, int device_type, int button_id) {
-    if (!ctx) return false;
-    
+/* Resolve a mapped button query against the configured actions */
+static bool spen_resolve_mapped_button(spen_context_t* ctx, int device_type, int button_id) {
     /* Mouse device button mapping */
     if (device_type == 1) { /* RETRO_DEVICE_MOUSE equivalent */
         switch (button_id) {
@@ -311,4 +541,120 @@ bool spen_get_mapped_button(spen_context_t* ctx, int device_type, int button_id)
     }
     
     return false;
+}
+
+bool spen_get_mapped_button(spen_context_t* ctx, int device_type, int button_id) {
+    if (!ctx) return false;
+    
+    bool result = spen_resolve_mapped_button(ctx, device_type, button_id);
+    spen_trace(ctx, spen_now(ctx), SPEN_TRACE_MAPPING,
+               (unsigned)device_type, (unsigned)button_id,
+               ctx->current_state.x, ctx->current_state.y, result ? 1 : 0);
+    return result;
+}
+
+uint32_t spen_get_generation(spen_context_t* ctx) {
+    if (!ctx) return 0;
+    return SPEN_WAKE_LOAD(&ctx->generation);
+}
+
+int spen_get_wake_fd(spen_context_t* ctx) {
+    if (!ctx) return -1;
+    return ctx->wake_read_fd;
+}
+
+void spen_ack_wake(spen_context_t* ctx) {
+    if (!ctx) return;
+    
+#ifdef SPEN_HAVE_WAKE_FD
+    if (ctx->wake_read_fd >= 0) {
+        uint64_t buffer;
+        for (;;) {
+            ssize_t count = read(ctx->wake_read_fd, &buffer, sizeof(buffer));
+            if (count > 0 || (count < 0 && errno == EINTR)) continue;
+            break;
+        }
+    }
+#endif
+    
+    /* Drain before re-arming so a change racing with the ack still signals */
+    SPEN_WAKE_CLEAR(&ctx->wake_pending);
+}
+
+size_t spen_trace_dump(spen_context_t* ctx, spen_trace_record_t* out,
+                       size_t max_records, uint32_t window_ms) {
+    if (!ctx || !out || max_records == 0) return 0;
+    
+    uint32_t head = SPEN_TRACE_LOAD(&ctx->trace_head);
+    uint32_t available = head < SPEN_TRACE_CAPACITY ? head : SPEN_TRACE_CAPACITY;
+    uint32_t now = (uint32_t)spen_now(ctx);
+    size_t count = 0;
+    
+    /* Walk backwards from the newest record until the ring or caller's buffer is exhausted */
+    for (uint32_t i = 0; i < available && count < max_records; i++) {
+        uint32_t index = head - 1 - i;
+        const spen_trace_record_t* rec = &ctx->trace[index & SPEN_TRACE_MASK];
+        
+        /* Skip slots that are being rewritten or already lapped by a writer */
+        spen_trace_record_t copy;
+        if (!spen_trace_read(rec, (uint16_t)index, &copy)) continue;
+        
+        /* Writers on different threads interleave, so timestamps are not monotonic */
+        if (window_ms && (uint32_t)(now - copy.timestamp_ms) > window_ms) continue;
+        out[count++] = copy;
+    }
+    
+    /* Return oldest first */
+    for (size_t i = 0; i < count / 2; i++) {
+        spen_trace_record_t tmp = out[i];
+        out[i] = out[count - 1 - i];
+        out[count - 1 - i] = tmp;
+    }
+    
+    return count;
+}
+
+int spen_trace_save(spen_context_t* ctx, const char* path, uint32_t window_ms) {
+    if (!ctx || !path) return -1;
+    
+    spen_trace_record_t* records = malloc(sizeof(spen_trace_record_t) * SPEN_TRACE_CAPACITY);
+    if (!records) return -1;
+    
+    spen_trace_file_header_t header;
+    header.magic = SPEN_TRACE_FILE_MAGIC;
+    header.version = SPEN_TRACE_FILE_VERSION;
+    header.record_size = sizeof(spen_trace_record_t);
+    header.record_count = (uint32_t)spen_trace_dump(ctx, records, SPEN_TRACE_CAPACITY, window_ms);
+    header.saved_at_ms = (uint32_t)spen_now(ctx);
+    
+    FILE* file = fopen(path, "wb");
+    if (!file) {
+        free(records);
+        return -1;
+    }
+    
+    bool ok = fwrite(&header, sizeof(header), 1, file) == 1 &&
+              fwrite(records, sizeof(spen_trace_record_t), header.record_count, file) ==
+                  header.record_count;
+    ok = (fclose(file) == 0) && ok;
+    free(records);
+    
+    return ok ? (int)header.record_count : -1;
+}
+
+const char* spen_trace_event_name(spen_trace_event_t event) {
+    switch (event) {
+        case SPEN_TRACE_HOVER: return "HOVER";
+        case SPEN_TRACE_CONTACT: return "CONTACT";
+        case SPEN_TRACE_BUTTON: return "BUTTON";
+        case SPEN_TRACE_TOOL_TYPE: return "TOOL_TYPE";
+        case SPEN_TRACE_GUARD_ARM: return "GUARD_ARM";
+        case SPEN_TRACE_GUARD_DISARM: return "GUARD_DISARM";
+        case SPEN_TRACE_GUARD_EXPIRE: return "GUARD_EXPIRE";
+        case SPEN_TRACE_GUARD_SUPPRESS: return "GUARD_SUPPRESS";
+        case SPEN_TRACE_POLL: return "POLL";
+        case SPEN_TRACE_MAPPING: return "MAPPING";
+        case SPEN_TRACE_TRANSFORM: return "TRANSFORM";
+        default: return "UNKNOWN";
+    }
 }
\ No newline at end of file
@@ -3,6 +3,7 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <stddef.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -131,6 +132,16 @@ void spen_set_coordinate_transform(spen_context_t* ctx,
                                    spen_coordinate_transform_t transform_func,
                                    void* user_data);
 
+/**
+ * Override the time source used for timestamps and the hover guard
+ * @param ctx S-Pen context
+ * @param clock_func Function returning the current time in milliseconds,
+ *                   or NULL to restore the monotonic system clock
+ * @param user_data Passed to clock_func
+ */
+typedef uint64_t (*spen_clock_t)(void* user_data);
+void spen_set_clock(spen_context_t* ctx, spen_clock_t clock_func, void* user_data);
+
 /**
  * Configure hover guard settings
  * @param ctx S-Pen context
@@ -183,6 +194,114 @@ void spen_configure_mapping(spen_context_t* ctx,
  */
 bool spen_get_mapped_button(spen_context_t* ctx, int device_type, int button_id);
 
+/**
+ * Get the change generation counter
+ *
+ * Incremented whenever pen input changes position, pressure, contact/hover,
+ * buttons or tool type. Frontends compare it against the value seen on the
+ * previous frame to skip input work while the pen is idle.
+ * @param ctx S-Pen context
+ * @return Current generation (wraps around)
+ */
+uint32_t spen_get_generation(spen_context_t* ctx);
+
+/**
+ * Get a descriptor that becomes readable when pen state changes
+ *
+ * Created by spen_init() (eventfd on Linux, pipe elsewhere) and owned by the
+ * context. Wake-ups are coalesced: a burst of changes signals the descriptor
+ * once until spen_ack_wake() is called.
+ * @param ctx S-Pen context
+ * @return Non-blocking readable descriptor, or -1 if unsupported or on failure
+ */
+int spen_get_wake_fd(spen_context_t* ctx);
+
+/**
+ * Consume a pending wake-up and re-arm notification
+ *
+ * Call before reading spen_get_generation() so that changes arriving after
+ * the ack signal the descriptor again.
+ * @param ctx S-Pen context
+ */
+void spen_ack_wake(spen_context_t* ctx);
+
+/**
+ * Flight recorder of adapter decisions
+ *
+ * Every context keeps a fixed-size ring of compact binary records describing
+ * what the adapter did: input events, hover guard arm/expire/suppress,
+ * mapping results, transform outputs and pointer polls. Recording is always
+ * on; the oldest records are overwritten once the ring is full. Input events
+ * and core polls may record from different threads, and dumps may run from
+ * any thread.
+ */
+#define SPEN_TRACE_CAPACITY 4096   /* Records per context, power of two */
+
+typedef enum {
+    SPEN_TRACE_HOVER = 0,          /* x, y = position, value = pressure * 1000 */
+    SPEN_TRACE_CONTACT = 1,        /* x, y = position, value = pressure * 1000 */
+    SPEN_TRACE_BUTTON = 2,         /* arg0 = button, arg1 = pressed */
+    SPEN_TRACE_TOOL_TYPE = 3,      /* arg0 = tool type */
+    SPEN_TRACE_GUARD_ARM = 4,      /* Guard went active: x, y = position, value = guard time ms */
+    SPEN_TRACE_GUARD_DISARM = 5,   /* x, y = contact position */
+    SPEN_TRACE_GUARD_EXPIRE = 6,   /* x, y = pointer position */
+    SPEN_TRACE_GUARD_SUPPRESS = 7, /* arg0 = device, arg1 = id, value = distance px */
+    SPEN_TRACE_POLL = 8,           /* arg0 = device, arg1 = id, value = returned state */
+    SPEN_TRACE_MAPPING = 9,        /* arg0 = device type, arg1 = button id, value = result */
+    SPEN_TRACE_TRANSFORM = 10,     /* x, y = transformed output */
+    SPEN_TRACE_EVENT_COUNT
+} spen_trace_event_t;
+
+typedef struct {
+    uint32_t timestamp_ms;         /* Low 32 bits of the monotonic ms clock */
+    uint8_t event;                 /* spen_trace_event_t */
+    uint8_t arg0;                  /* Event specific, see spen_trace_event_t */
+    uint8_t arg1;                  /* Event specific, see spen_trace_event_t */
+    uint8_t reserved;
+    int16_t x, y;                  /* Coordinates, saturated to int16 range */
+    int16_t value;                 /* Event specific result */
+    uint16_t seq;                  /* Low 16 bits of the record sequence number */
+} spen_trace_record_t;
+
+/* Layout of files written by spen_trace_save: header followed by records */
+#define SPEN_TRACE_FILE_MAGIC 0x52545053u   /* "SPTR" little-endian */
+#define SPEN_TRACE_FILE_VERSION 1u
+
+typedef struct {
+    uint32_t magic;                /* SPEN_TRACE_FILE_MAGIC */
+    uint32_t version;              /* SPEN_TRACE_FILE_VERSION */
+    uint32_t record_size;          /* sizeof(spen_trace_record_t) */
+    uint32_t record_count;         /* Records following the header */
+    uint32_t saved_at_ms;          /* Clock value when the dump was taken */
+} spen_trace_file_header_t;
+
+/**
+ * Copy the most recent flight recorder records, oldest first
+ * @param ctx S-Pen context
+ * @param out Destination array
+ * @param max_records Capacity of out
+ * @param window_ms Only records from the last window_ms milliseconds (0 = all)
+ * @return Number of records copied
+ */
+size_t spen_trace_dump(spen_context_t* ctx, spen_trace_record_t* out,
+                       size_t max_records, uint32_t window_ms);
+
+/**
+ * Write the most recent flight recorder records to a file for spen_trace_decode
+ * @param ctx S-Pen context
+ * @param path Output file path
+ * @param window_ms Only records from the last window_ms milliseconds (0 = all)
+ * @return Number of records written, or -1 on failure
+ */
+int spen_trace_save(spen_context_t* ctx, const char* path, uint32_t window_ms);
+
+/**
+ * Get a printable name for a flight recorder event
+ * @param event Event type
+ * @return Static event name
+ */
+const char* spen_trace_event_name(spen_trace_event_t event);
+
 #ifdef __cplusplus
 }
 #endif
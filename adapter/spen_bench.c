@@ -0,0 +1,480 @@
+#include "spen_adapter.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+
+/*
+ * Mock-core latency and conformance benchmark
+ *
+ * Replays synthetic or recorded pen strokes through the adapter while mock
+ * cores poll it once per frame the way the SNES9x, MAME 2016 and SwanStation
+ * integrations do. Latency, dropped taps and coordinate error come from a
+ * pass on a simulated clock, so they are deterministic and need no device.
+ * Adapter CPU cost comes from a second pass on the adapter's default clock,
+ * so it includes the time source reads the adapter makes in production. It
+ * is reported per frame in two parts: delivering that frame's pen samples
+ * (state updates, trace records, wake-up writes) and acking the wake-up plus
+ * the core's poll sequence.
+ *
+ * Usage: spen_bench [strokes.txt]
+ *
+ * Recorded stroke files hold one sample per line:
+ *   <time_ms> <h|c|b|r> <x> <y> <pressure>
+ * where h = hover, c = contact, b = barrel pressed, r = barrel released and
+ * x/y are in libretro pointer range (-32768..32767). Lines starting with '#'
+ * are ignored.
+ */
+
+/* Libretro device and id values used by the mock cores */
+#define RETRO_DEVICE_MOUSE 2
+#define RETRO_DEVICE_POINTER 6
+#define RETRO_DEVICE_ID_MOUSE_LEFT 2
+#define RETRO_DEVICE_ID_MOUSE_RIGHT 3
+#define RETRO_DEVICE_ID_POINTER_X 0
+#define RETRO_DEVICE_ID_POINTER_Y 1
+#define RETRO_DEVICE_ID_POINTER_PRESSED 2
+#define RETRO_DEVICE_ID_POINTER_COUNT 3
+
+/* Device/button ids understood by spen_get_mapped_button() */
+#define SPEN_MAPPED_MOUSE 1
+#define SPEN_MAPPED_LIGHTGUN 6
+#define SPEN_MAPPED_LIGHTGUN_TRIGGER 2
+#define SPEN_MAPPED_LIGHTGUN_RELOAD 16
+
+/* Synthetic strokes are sampled at the S-Pen digitizer rate */
+#define BENCH_SAMPLE_INTERVAL_MS 4
+
+typedef struct {
+    uint32_t t_ms;
+    char type;                     /* h, c, b or r */
+    float x, y;
+    float pressure;
+} bench_sample_t;
+
+typedef struct {
+    bench_sample_t* samples;
+    size_t count;
+    size_t capacity;
+} bench_stroke_t;
+
+/* What a mock core observed during one frame */
+typedef struct {
+    float x, y;                    /* Core-space coordinates */
+    bool coords_valid;             /* Core updated its cursor this frame */
+    bool pressed;                  /* Primary action (click/trigger) */
+} bench_frame_t;
+
+typedef struct {
+    const char* name;
+    spen_action_t tap_action;
+    spen_action_t barrel_action;
+    spen_hover_behavior_t hover_behavior;
+    void (*poll)(spen_context_t* ctx, bench_frame_t* frame);
+    void (*to_core)(float x, float y, float* core_x, float* core_y);
+    double coord_tolerance;        /* Largest per-axis error in core units */
+} bench_profile_t;
+
+typedef struct {
+    unsigned taps;
+    unsigned dropped_taps;
+    double latency_sum_frames;
+    double latency_max_frames;
+    double coord_error_sum;
+    double coord_error_max;
+    unsigned coord_samples;
+    double deliver_mean_ns;
+    double deliver_p99_ns;
+    double poll_mean_ns;
+    double poll_p99_ns;
+} bench_result_t;
+
+/* Simulated clock shared with the adapter */
+static uint64_t bench_clock_ms;
+
+static uint64_t bench_clock(void* user_data) {
+    (void)user_data;
+    return bench_clock_ms;
+}
+
+/* No physical devices are attached; every query not served by the adapter is idle */
+static int16_t bench_input_cb(unsigned port, unsigned device, unsigned index, unsigned id) {
+    (void)port; (void)device; (void)index; (void)id;
+    return 0;
+}
+
+static int16_t bench_query(spen_context_t* ctx, unsigned device, unsigned id) {
+    return spen_emit_libretro_pointer(ctx, bench_input_cb, 0, device, 0, id);
+}
+
+static uint64_t bench_time_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+/*
+ * SNES9x mouse in absolute mode (Mario Paint): coordinates are only read
+ * while pressed, and the left button is the mouse button OR pointer pressed.
+ */
+static void snes9x_poll(spen_context_t* ctx, bench_frame_t* frame) {
+    int pressed = bench_query(ctx, RETRO_DEVICE_POINTER, RETRO_DEVICE_ID_POINTER_PRESSED);
+    if (pressed) {
+        int pointer_x = bench_query(ctx, RETRO_DEVICE_POINTER, RETRO_DEVICE_ID_POINTER_X);
+        int pointer_y = bench_query(ctx, RETRO_DEVICE_POINTER, RETRO_DEVICE_ID_POINTER_Y);
+        frame->x = (float)(((pointer_x + 32768) * 256) / 65536);
+        frame->y = (float)(((pointer_y + 32768) * 224) / 65536);
+        frame->coords_valid = true;
+    }
+    bool left = bench_query(ctx, RETRO_DEVICE_MOUSE, RETRO_DEVICE_ID_MOUSE_LEFT) || pressed;
+    (void)bench_query(ctx, RETRO_DEVICE_MOUSE, RETRO_DEVICE_ID_MOUSE_RIGHT);
+    frame->pressed = left;
+}
+
+static void snes9x_to_core(float x, float y, float* core_x, float* core_y) {
+    *core_x = (x + 32768.0f) * 256.0f / 65536.0f;
+    *core_y = (y + 32768.0f) * 224.0f / 65536.0f;
+}
+
+/* MAME 2016: always polls all pointer ids and scales to MAME's absolute range */
+static void mame2016_poll(spen_context_t* ctx, bench_frame_t* frame) {
+    int16_t pointer_x = bench_query(ctx, RETRO_DEVICE_POINTER, RETRO_DEVICE_ID_POINTER_X);
+    int16_t pointer_y = bench_query(ctx, RETRO_DEVICE_POINTER, RETRO_DEVICE_ID_POINTER_Y);
+    bool pressed = bench_query(ctx, RETRO_DEVICE_POINTER, RETRO_DEVICE_ID_POINTER_PRESSED);
+    int count = bench_query(ctx, RETRO_DEVICE_POINTER, RETRO_DEVICE_ID_POINTER_COUNT);
+    (void)spen_get_mapped_button(ctx, SPEN_MAPPED_MOUSE, 1);
+
+    frame->x = (float)((int)pointer_x * 2);
+    frame->y = (float)((int)pointer_y * 2);
+    frame->coords_valid = count > 0;
+    frame->pressed = pressed;
+}
+
+static void mame2016_to_core(float x, float y, float* core_x, float* core_y) {
+    *core_x = x * 2.0f;
+    *core_y = y * 2.0f;
+}
+
+/* SwanStation GunCon: display-aware scaling, trigger and reload via mapping */
+#define SWANSTATION_WINDOW_WIDTH 640
+#define SWANSTATION_WINDOW_HEIGHT 480
+
+static void swanstation_poll(spen_context_t* ctx, bench_frame_t* frame) {
+    int16_t pointer_x = bench_query(ctx, RETRO_DEVICE_POINTER, RETRO_DEVICE_ID_POINTER_X);
+    int16_t pointer_y = bench_query(ctx, RETRO_DEVICE_POINTER, RETRO_DEVICE_ID_POINTER_Y);
+    (void)bench_query(ctx, RETRO_DEVICE_POINTER, RETRO_DEVICE_ID_POINTER_PRESSED);
+    int count = bench_query(ctx, RETRO_DEVICE_POINTER, RETRO_DEVICE_ID_POINTER_COUNT);
+    bool trigger = spen_get_mapped_button(ctx, SPEN_MAPPED_LIGHTGUN, SPEN_MAPPED_LIGHTGUN_TRIGGER);
+    (void)spen_get_mapped_button(ctx, SPEN_MAPPED_LIGHTGUN, SPEN_MAPPED_LIGHTGUN_RELOAD);
+
+    frame->x = (float)((((int32_t)pointer_x + 0x8000) * SWANSTATION_WINDOW_WIDTH) / 0x10000);
+    frame->y = (float)((((int32_t)pointer_y + 0x8000) * SWANSTATION_WINDOW_HEIGHT) / 0x10000);
+    frame->coords_valid = count > 0;
+    frame->pressed = trigger;
+}
+
+static void swanstation_to_core(float x, float y, float* core_x, float* core_y) {
+    *core_x = (x + 32768.0f) * SWANSTATION_WINDOW_WIDTH / 65536.0f;
+    *core_y = (y + 32768.0f) * SWANSTATION_WINDOW_HEIGHT / 65536.0f;
+}
+
+/*
+ * Tolerances cover the core's own integer scaling plus the adapter truncating
+ * to whole libretro units (one unit is two MAME units).
+ */
+static const bench_profile_t bench_profiles[] = {
+    { "snes9x-mouse", SPEN_ACTION_LEFT_CLICK, SPEN_ACTION_RIGHT_CLICK,
+      SPEN_HOVER_CURSOR, snes9x_poll, snes9x_to_core, 1.0 + 256.0 / 65536.0 },
+    { "mame2016", SPEN_ACTION_LEFT_CLICK, SPEN_ACTION_RIGHT_CLICK,
+      SPEN_HOVER_CURSOR, mame2016_poll, mame2016_to_core, 2.0 },
+    { "swanstation-guncon", SPEN_ACTION_TRIGGER, SPEN_ACTION_RELOAD,
+      SPEN_HOVER_LIGHTGUN_TRACKING, swanstation_poll, swanstation_to_core,
+      1.0 + SWANSTATION_WINDOW_WIDTH / 65536.0 },
+};
+
+static const unsigned bench_frame_rates[] = { 60, 120 };
+
+static bool stroke_push(bench_stroke_t* stroke, uint32_t t_ms, char type,
+                        float x, float y, float pressure) {
+    if (stroke->count == stroke->capacity) {
+        size_t capacity = stroke->capacity ? stroke->capacity * 2 : 256;
+        bench_sample_t* samples = realloc(stroke->samples, capacity * sizeof(bench_sample_t));
+        if (!samples) return false;
+        stroke->samples = samples;
+        stroke->capacity = capacity;
+    }
+
+    bench_sample_t* sample = &stroke->samples[stroke->count++];
+    sample->t_ms = t_ms;
+    sample->type = type;
+    sample->x = x;
+    sample->y = y;
+    sample->pressure = pressure;
+    return true;
+}
+
+/*
+ * Synthetic session: hover-approach taps of decreasing length (down to
+ * sub-frame taps), a drawn circle, then a hover sweep across the screen.
+ */
+static bool stroke_synthesize(bench_stroke_t* stroke) {
+    static const uint32_t tap_lengths_ms[] = { 80, 50, 33, 20, 12, 8, 4 };
+    uint32_t t = 0;
+    bool ok = true;
+
+    for (size_t i = 0; i < sizeof(tap_lengths_ms) / sizeof(tap_lengths_ms[0]); i++) {
+        for (int rep = 0; rep < 4; rep++) {
+            float x = -20000.0f + 5000.0f * (float)rep;
+            float y = -10000.0f + 3000.0f * (float)i;
+
+            /* Approach, tap, lift, idle */
+            for (int k = 0; k < 10; k++, t += BENCH_SAMPLE_INTERVAL_MS) {
+                ok = ok && stroke_push(stroke, t, 'h', x - 40.0f * (float)(10 - k), y, 0.0f);
+            }
+            for (uint32_t held = 0; held < tap_lengths_ms[i]; held += BENCH_SAMPLE_INTERVAL_MS) {
+                ok = ok && stroke_push(stroke, t, 'c', x, y, 0.6f);
+                t += BENCH_SAMPLE_INTERVAL_MS;
+            }
+            for (int k = 0; k < 30; k++, t += BENCH_SAMPLE_INTERVAL_MS) {
+                ok = ok && stroke_push(stroke, t, 'h', x, y, 0.0f);
+            }
+        }
+    }
+
+    /* One second circle in contact */
+    for (int k = 0; k < 1000 / BENCH_SAMPLE_INTERVAL_MS; k++, t += BENCH_SAMPLE_INTERVAL_MS) {
+        float angle = 2.0f * 3.14159265f * (float)k * BENCH_SAMPLE_INTERVAL_MS / 1000.0f;
+        ok = ok && stroke_push(stroke, t, 'c', 12000.0f * cosf(angle),
+                               12000.0f * sinf(angle), 0.5f);
+    }
+
+    /* Half second hover sweep with a barrel click in the middle */
+    for (int k = 0; k < 500 / BENCH_SAMPLE_INTERVAL_MS; k++, t += BENCH_SAMPLE_INTERVAL_MS) {
+        float x = -30000.0f + 60000.0f * (float)k * BENCH_SAMPLE_INTERVAL_MS / 500.0f;
+        if (k == 50) ok = ok && stroke_push(stroke, t, 'b', x, 0.0f, 0.0f);
+        if (k == 60) ok = ok && stroke_push(stroke, t, 'r', x, 0.0f, 0.0f);
+        ok = ok && stroke_push(stroke, t, 'h', x, 0.0f, 0.0f);
+    }
+
+    return ok;
+}
+
+static bool stroke_load(bench_stroke_t* stroke, const char* path) {
+    FILE* file = fopen(path, "r");
+    if (!file) {
+        perror(path);
+        return false;
+    }
+
+    char line[256];
+    unsigned line_no = 0;
+    bool ok = true;
+    while (ok && fgets(line, sizeof(line), file)) {
+        line_no++;
+        if (line[0] == '#' || line[0] == '\n') continue;
+
+        unsigned t_ms;
+        char type;
+        float x, y, pressure;
+        if (sscanf(line, "%u %c %f %f %f", &t_ms, &type, &x, &y, &pressure) != 5 ||
+            !strchr("hcbr", type) ||
+            (stroke->count && t_ms < stroke->samples[stroke->count - 1].t_ms)) {
+            fprintf(stderr, "%s:%u: malformed or out-of-order sample\n", path, line_no);
+            ok = false;
+            break;
+        }
+        ok = stroke_push(stroke, t_ms, type, x, y, pressure);
+    }
+
+    fclose(file);
+    return ok && stroke->count > 0;
+}
+
+static void stroke_deliver(spen_context_t* ctx, const bench_sample_t* sample) {
+    bench_clock_ms = sample->t_ms;
+    switch (sample->type) {
+        case 'h':
+            spen_on_hover(ctx, sample->x, sample->y, sample->pressure);
+            break;
+        case 'c':
+            spen_on_contact(ctx, sample->x, sample->y, sample->pressure);
+            break;
+        case 'b':
+            spen_on_button(ctx, SPEN_BUTTON_BARREL, true);
+            break;
+        case 'r':
+            spen_on_button(ctx, SPEN_BUTTON_BARREL, false);
+            break;
+    }
+}
+
+static int compare_u64(const void* a, const void* b) {
+    uint64_t x = *(const uint64_t*)a;
+    uint64_t y = *(const uint64_t*)b;
+    return (x > y) - (x < y);
+}
+
+/*
+ * Replay the stroke against one profile. The timed pass runs on the default
+ * clock and fills in CPU cost only; the other pass runs on the simulated
+ * clock and fills in latency, dropped taps and coordinate error.
+ */
+/* Mean and 99th percentile of per-frame timings; sorts the samples */
+static void bench_summarize(uint64_t* ns, size_t frames, double* mean, double* p99) {
+    uint64_t total_ns = 0;
+    for (size_t f = 0; f < frames; f++) total_ns += ns[f];
+    qsort(ns, frames, sizeof(uint64_t), compare_u64);
+    *mean = (double)total_ns / (double)frames;
+    *p99 = (double)ns[(frames * 99) / 100];
+}
+
+static bool bench_run(const bench_profile_t* profile, unsigned fps,
+                      const bench_stroke_t* stroke, bool timed, bench_result_t* result) {
+    spen_context_t* ctx = spen_init();
+    if (!ctx) return false;
+
+    bench_clock_ms = 0;
+    if (!timed) {
+        spen_set_clock(ctx, bench_clock, NULL);
+    }
+    spen_configure_mapping(ctx, profile->tap_action, profile->barrel_action,
+                           profile->hover_behavior, 0.1f);
+
+    double frame_ms = 1000.0 / fps;
+    uint32_t end_ms = stroke->samples[stroke->count - 1].t_ms + 2 * (uint32_t)ceil(frame_ms);
+    size_t frames = (size_t)(end_ms / frame_ms) + 1;
+    uint64_t* deliver_ns = malloc(frames * sizeof(uint64_t));
+    uint64_t* poll_ns = malloc(frames * sizeof(uint64_t));
+    if (!deliver_ns || !poll_ns) {
+        free(deliver_ns);
+        free(poll_ns);
+        spen_cleanup(ctx);
+        return false;
+    }
+
+    size_t next = 0;
+    bool contact = false;
+    bool tap_pending = false;          /* Current tap not yet seen by the core */
+    uint32_t tap_start_ms = 0;
+    const bench_sample_t* last_position = NULL;
+
+    for (size_t f = 0; f < frames; f++) {
+        uint32_t frame_ms_now = (uint32_t)(f * frame_ms);
+
+        /* Frontend delivers every pen sample that arrived before this frame */
+        uint64_t start = bench_time_ns();
+        while (next < stroke->count && stroke->samples[next].t_ms <= frame_ms_now) {
+            const bench_sample_t* sample = &stroke->samples[next++];
+            stroke_deliver(ctx, sample);
+
+            if (!timed && (sample->type == 'h' || sample->type == 'c')) {
+                bool now_contact = sample->type == 'c';
+                if (now_contact && !contact) {
+                    if (tap_pending) result->dropped_taps++;
+                    result->taps++;
+                    tap_pending = true;
+                    tap_start_ms = sample->t_ms;
+                }
+                contact = now_contact;
+                last_position = sample;
+            }
+        }
+        deliver_ns[f] = bench_time_ns() - start;
+        bench_clock_ms = frame_ms_now;
+
+        /* Frontend re-arms the wake-up, then the core polls once per frame */
+        bench_frame_t frame = { 0.0f, 0.0f, false, false };
+        start = bench_time_ns();
+        spen_ack_wake(ctx);
+        profile->poll(ctx, &frame);
+        poll_ns[f] = bench_time_ns() - start;
+
+        if (timed) continue;
+
+        if (tap_pending && frame.pressed) {
+            /* Visible once the frame that consumed the press is presented */
+            double latency = (frame_ms_now + frame_ms - tap_start_ms) / frame_ms;
+            result->latency_sum_frames += latency;
+            if (latency > result->latency_max_frames) result->latency_max_frames = latency;
+            tap_pending = false;
+        }
+
+        if (frame.coords_valid && last_position) {
+            float expected_x, expected_y;
+            profile->to_core(last_position->x, last_position->y, &expected_x, &expected_y);
+            double error = fmax(fabs(frame.x - expected_x), fabs(frame.y - expected_y));
+            result->coord_error_sum += error;
+            if (error > result->coord_error_max) result->coord_error_max = error;
+            result->coord_samples++;
+        }
+    }
+    if (tap_pending) result->dropped_taps++;
+
+    if (timed) {
+        bench_summarize(deliver_ns, frames, &result->deliver_mean_ns, &result->deliver_p99_ns);
+        bench_summarize(poll_ns, frames, &result->poll_mean_ns, &result->poll_p99_ns);
+    }
+
+    free(deliver_ns);
+    free(poll_ns);
+    spen_cleanup(ctx);
+    return true;
+}
+
+int main(int argc, char** argv) {
+    if (argc > 2) {
+        fprintf(stderr, "Usage: %s [strokes.txt]\n", argv[0]);
+        return 2;
+    }
+
+    bench_stroke_t stroke = { NULL, 0, 0 };
+    bool loaded = argc == 2 ? stroke_load(&stroke, argv[1]) : stroke_synthesize(&stroke);
+    if (!loaded) {
+        fprintf(stderr, "Failed to %s strokes\n", argc == 2 ? "load" : "generate");
+        free(stroke.samples);
+        return 1;
+    }
+
+    printf("S-Pen Mock-Core Benchmark\n");
+    printf("=========================\n");
+    printf("Strokes: %s (%zu samples, %u ms)\n\n", argc == 2 ? argv[1] : "synthetic",
+           stroke.count, stroke.samples[stroke.count - 1].t_ms);
+    printf("%-20s %4s %6s %8s %10s %10s %10s %10s %11s %11s\n", "profile", "fps", "taps",
+           "dropped", "lat avg", "lat max", "err avg", "err max", "deliver ns", "poll ns");
+
+    bool conformant = true;
+    for (size_t p = 0; p < sizeof(bench_profiles) / sizeof(bench_profiles[0]); p++) {
+        for (size_t r = 0; r < sizeof(bench_frame_rates) / sizeof(bench_frame_rates[0]); r++) {
+            bench_result_t result;
+            memset(&result, 0, sizeof(result));
+            if (!bench_run(&bench_profiles[p], bench_frame_rates[r], &stroke, false, &result) ||
+                !bench_run(&bench_profiles[p], bench_frame_rates[r], &stroke, true, &result)) {
+                fprintf(stderr, "Out of memory\n");
+                free(stroke.samples);
+                return 1;
+            }
+
+            unsigned seen = result.taps - result.dropped_taps;
+            double latency_avg = seen ? result.latency_sum_frames / seen : 0.0;
+            double error_avg = result.coord_samples ?
+                               result.coord_error_sum / result.coord_samples : 0.0;
+            bool ok = result.coord_error_max <= bench_profiles[p].coord_tolerance;
+            conformant = conformant && ok;
+
+            printf("%-20s %4u %6u %8u %9.2ff %9.2ff %10.3f %10.3f  %4.0f/%-5.0f  %4.0f/%-5.0f%s\n",
+                   bench_profiles[p].name, bench_frame_rates[r], result.taps,
+                   result.dropped_taps, latency_avg, result.latency_max_frames,
+                   error_avg, result.coord_error_max,
+                   result.deliver_mean_ns, result.deliver_p99_ns,
+                   result.poll_mean_ns, result.poll_p99_ns, ok ? "" : "  COORD FAIL");
+        }
+    }
+
+    printf("\nlat = input-to-visible latency in frames, err = per-axis coordinate error in core units,\n");
+    printf("deliver = adapter time per frame handling pen samples, poll = wake ack + core queries\n");
+    printf("(both on the system clock, mean/p99)\n");
+
+    free(stroke.samples);
+    return conformant ? 0 : 1;
+}
@@ -2,6 +2,7 @@
 #include <stdio.h>
 #include <assert.h>
 #include <unistd.h>
+#include <poll.h>
 
 /* Mock libretro input callback for testing */
 int16_t mock_input_state_cb(unsigned port, unsigned device, unsigned index, unsigned id) {
@@ -188,6 +189,162 @@ void test_button_mapping(void) {
     printf("✓ Button mapping tests passed\n");
 }
 
+/* Simulated clock for deterministic hover guard timing */
+static uint64_t test_clock_ms;
+
+static uint64_t test_clock(void* user_data) {
+    (void)user_data;
+    return test_clock_ms;
+}
+
+void test_clock_override(void) {
+    printf("Testing clock override...\n");
+    
+    spen_context_t* ctx = spen_init();
+    assert(ctx != NULL);
+    
+    test_clock_ms = 1000;
+    spen_set_clock(ctx, test_clock, NULL);
+    spen_configure_hover_guard(ctx, 50, 10.0f);
+    
+    spen_on_hover(ctx, 100.0f, 100.0f, 0.0f);
+    assert(spen_get_state(ctx)->timestamp == 1000);
+    
+    /* Inside the guard window a nearby non-pointer query is suppressed */
+    test_clock_ms = 1020;
+    (void)spen_emit_libretro_pointer(ctx, mock_input_state_cb, 0, 2, 0, 2);
+    
+    /* After the window the guard expires */
+    test_clock_ms = 1060;
+    (void)spen_emit_libretro_pointer(ctx, mock_input_state_cb, 0, 2, 0, 2);
+    
+    spen_trace_record_t records[8];
+    size_t count = spen_trace_dump(ctx, records, 8, 0);
+    assert(count == 6);
+    assert(records[2].event == SPEN_TRACE_GUARD_SUPPRESS);
+    assert(records[2].timestamp_ms == 1020);
+    assert(records[4].event == SPEN_TRACE_GUARD_EXPIRE);
+    assert(records[4].timestamp_ms == 1060);
+    
+    /* Window filtering follows the overridden clock */
+    assert(spen_trace_dump(ctx, records, 8, 10) == 2);
+    
+    spen_cleanup(ctx);
+    printf("✓ Clock override tests passed\n");
+}
+
+void test_flight_recorder(void) {
+    printf("Testing flight recorder...\n");
+    
+    spen_context_t* ctx = spen_init();
+    assert(ctx != NULL);
+    
+    static spen_trace_record_t records[SPEN_TRACE_CAPACITY];
+    assert(spen_trace_dump(ctx, records, SPEN_TRACE_CAPACITY, 0) == 0);
+    
+    /* Hover arms the guard, a nearby contact disarms it */
+    spen_on_hover(ctx, 100.0f, 100.0f, 0.2f);
+    spen_on_contact(ctx, 105.0f, 105.0f, 0.5f);
+    (void)spen_emit_libretro_pointer(ctx, mock_input_state_cb, 0, 6, 0, 2);
+    (void)spen_get_mapped_button(ctx, 1, 0);
+    
+    size_t count = spen_trace_dump(ctx, records, SPEN_TRACE_CAPACITY, 1000);
+    assert(count == 6);
+    assert(records[0].event == SPEN_TRACE_HOVER);
+    assert(records[1].event == SPEN_TRACE_GUARD_ARM);
+    assert(records[2].event == SPEN_TRACE_CONTACT);
+    assert(records[2].x == 105 && records[2].value == 500);
+    assert(records[3].event == SPEN_TRACE_GUARD_DISARM);
+    assert(records[4].event == SPEN_TRACE_POLL);
+    assert(records[4].arg0 == 6 && records[4].arg1 == 2 && records[4].value == 1);
+    assert(records[5].event == SPEN_TRACE_MAPPING && records[5].value == 1);
+    
+    /* Dump keeps only the newest records when the caller's buffer is small */
+    count = spen_trace_dump(ctx, records, 2, 0);
+    assert(count == 2);
+    assert(records[0].event == SPEN_TRACE_POLL);
+    assert(records[1].event == SPEN_TRACE_MAPPING);
+    
+    /* Ring wraps without losing the newest record */
+    for (int i = 0; i < SPEN_TRACE_CAPACITY + 10; i++) {
+        spen_on_button(ctx, SPEN_BUTTON_BARREL, i & 1);
+    }
+    count = spen_trace_dump(ctx, records, SPEN_TRACE_CAPACITY, 0);
+    assert(count == SPEN_TRACE_CAPACITY);
+    assert(records[count - 1].event == SPEN_TRACE_BUTTON);
+    assert(records[count - 1].arg1 == ((SPEN_TRACE_CAPACITY + 9) & 1));
+    
+    /* Round-trip through the decoder file format */
+    const char* path = "spen_trace_test.bin";
+    assert(spen_trace_save(ctx, path, 0) == SPEN_TRACE_CAPACITY);
+    FILE* file = fopen(path, "rb");
+    assert(file != NULL);
+    spen_trace_file_header_t header;
+    assert(fread(&header, sizeof(header), 1, file) == 1);
+    assert(header.magic == SPEN_TRACE_FILE_MAGIC);
+    assert(header.record_count == SPEN_TRACE_CAPACITY);
+    fclose(file);
+    unlink(path);
+    
+    spen_cleanup(ctx);
+    printf("✓ Flight recorder tests passed\n");
+}
+
+/* Check whether a descriptor is readable without blocking */
+static bool test_fd_readable(int fd) {
+    struct pollfd pfd = { fd, POLLIN, 0 };
+    return poll(&pfd, 1, 0) == 1 && (pfd.revents & POLLIN);
+}
+
+void test_wake_notification(void) {
+    printf("Testing wake-on-input notification...\n");
+    
+    spen_context_t* ctx = spen_init();
+    assert(ctx != NULL);
+    
+    uint32_t generation = spen_get_generation(ctx);
+    int fd = spen_get_wake_fd(ctx);
+    assert(fd >= 0);
+    assert(spen_get_wake_fd(ctx) == fd);
+    assert(!test_fd_readable(fd));
+    
+    /* A burst of changes produces a single wake-up */
+    spen_on_hover(ctx, 100.0f, 100.0f, 0.0f);
+    spen_on_hover(ctx, 110.0f, 100.0f, 0.0f);
+    spen_on_contact(ctx, 110.0f, 100.0f, 0.5f);
+    spen_on_button(ctx, SPEN_BUTTON_BARREL, true);
+    assert(test_fd_readable(fd));
+    assert(spen_get_generation(ctx) == generation + 4);
+    
+    spen_ack_wake(ctx);
+    assert(!test_fd_readable(fd));
+    generation = spen_get_generation(ctx);
+    
+    /* Repeating identical state is not a change */
+    spen_on_contact(ctx, 110.0f, 100.0f, 0.5f);
+    spen_on_button(ctx, SPEN_BUTTON_BARREL, true);
+    assert(!test_fd_readable(fd));
+    assert(spen_get_generation(ctx) == generation);
+    
+    /* Next change after the ack signals again */
+    spen_on_tool_type(ctx, SPEN_TOOL_STYLUS);
+    assert(test_fd_readable(fd));
+    assert(spen_get_generation(ctx) == generation + 1);
+    spen_ack_wake(ctx);
+    
+    /* Changes made before the frontend asks for the descriptor are still signalled */
+    spen_context_t* late = spen_init();
+    assert(late != NULL);
+    spen_on_hover(late, 5.0f, 5.0f, 0.0f);
+    int late_fd = spen_get_wake_fd(late);
+    assert(late_fd >= 0);
+    assert(test_fd_readable(late_fd));
+    spen_cleanup(late);
+    
+    spen_cleanup(ctx);
+    printf("✓ Wake notification tests passed\n");
+}
+
 int main(void) {
     printf("S-Pen Adapter Test Harness\n");
     printf("==========================\n\n");
@@ -197,6 +354,9 @@ int main(void) {
     test_coordinate_transformation();
     test_hover_guard();
     test_button_mapping();
+    test_flight_recorder();
+    test_clock_override();
+    test_wake_notification();
     
     printf("\n✅ All tests passed!\n");
     printf("\nThis demonstrates the S-Pen adapter can:\n");
@@ -207,6 +367,8 @@ int main(void) {
     printf("  • Provide hover guard against phantom touches\n");
     printf("  • Map barrel button to trigger/right-click/reload\n");
     printf("  • Use hover for lightgun tracking without shooting\n");
+    printf("  • Record adapter decisions in an always-on flight recorder\n");
+    printf("  • Wake idle frontends only when pen input changes\n");
     printf("\nThe adapter is ready for integration into libretro cores!\n");
     
     return 0;
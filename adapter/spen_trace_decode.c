@@ -0,0 +1,103 @@
+#include "spen_adapter.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+/* Decode a flight recorder dump written by spen_trace_save() */
+
+static void print_record(const spen_trace_record_t* rec, uint32_t saved_at_ms) {
+    /* Age relative to when the dump was taken, so the incident is at the bottom */
+    long age_ms = (long)(int32_t)(saved_at_ms - rec->timestamp_ms);
+
+    printf("%8ld ms  #%-5u %-15s", -age_ms, (unsigned)rec->seq,
+           spen_trace_event_name((spen_trace_event_t)rec->event));
+
+    switch (rec->event) {
+        case SPEN_TRACE_HOVER:
+        case SPEN_TRACE_CONTACT:
+            printf(" x=%d y=%d pressure=%.3f", rec->x, rec->y, rec->value / 1000.0);
+            break;
+        case SPEN_TRACE_BUTTON:
+            printf(" button=%u %s", rec->arg0, rec->arg1 ? "pressed" : "released");
+            break;
+        case SPEN_TRACE_TOOL_TYPE:
+            printf(" tool=%u", rec->arg0);
+            break;
+        case SPEN_TRACE_GUARD_ARM:
+            printf(" x=%d y=%d time=%dms", rec->x, rec->y, rec->value);
+            break;
+        case SPEN_TRACE_GUARD_DISARM:
+        case SPEN_TRACE_GUARD_EXPIRE:
+        case SPEN_TRACE_TRANSFORM:
+            printf(" x=%d y=%d", rec->x, rec->y);
+            break;
+        case SPEN_TRACE_GUARD_SUPPRESS:
+            printf(" device=%u id=%u x=%d y=%d distance=%dpx",
+                   rec->arg0, rec->arg1, rec->x, rec->y, rec->value);
+            break;
+        case SPEN_TRACE_POLL:
+            printf(" device=%u id=%u -> %d", rec->arg0, rec->arg1, rec->value);
+            break;
+        case SPEN_TRACE_MAPPING:
+            printf(" device=%u button=%u -> %d", rec->arg0, rec->arg1, rec->value);
+            break;
+        default:
+            printf(" arg0=%u arg1=%u x=%d y=%d value=%d",
+                   rec->arg0, rec->arg1, rec->x, rec->y, rec->value);
+            break;
+    }
+    printf("\n");
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2 || argc > 3) {
+        fprintf(stderr, "Usage: %s <trace-file> [last-seconds]\n", argv[0]);
+        return 2;
+    }
+
+    uint32_t window_ms = argc == 3 ? (uint32_t)(atof(argv[2]) * 1000.0) : 0;
+
+    FILE* file = fopen(argv[1], "rb");
+    if (!file) {
+        perror(argv[1]);
+        return 1;
+    }
+
+    spen_trace_file_header_t header;
+    if (fread(&header, sizeof(header), 1, file) != 1 ||
+        header.magic != SPEN_TRACE_FILE_MAGIC) {
+        fprintf(stderr, "%s: not an S-Pen trace file\n", argv[1]);
+        fclose(file);
+        return 1;
+    }
+    if (header.version != SPEN_TRACE_FILE_VERSION ||
+        header.record_size != sizeof(spen_trace_record_t)) {
+        fprintf(stderr, "%s: unsupported trace version %u (record size %u)\n",
+                argv[1], header.version, header.record_size);
+        fclose(file);
+        return 1;
+    }
+
+    printf("S-Pen flight recorder: %u records\n", header.record_count);
+
+    spen_trace_record_t rec;
+    uint32_t printed = 0;
+    for (uint32_t i = 0; i < header.record_count; i++) {
+        if (fread(&rec, sizeof(rec), 1, file) != 1) {
+            fprintf(stderr, "%s: truncated after %u records\n", argv[1], i);
+            fclose(file);
+            return 1;
+        }
+        if (window_ms && (uint32_t)(header.saved_at_ms - rec.timestamp_ms) > window_ms) {
+            continue;
+        }
+        print_record(&rec, header.saved_at_ms);
+        printed++;
+    }
+
+    if (window_ms) {
+        printf("%u records in the last %u ms\n", printed, window_ms);
+    }
+
+    fclose(file);
+    return 0;
+}